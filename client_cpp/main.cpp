@@ -23,10 +23,12 @@ const uint8_t TAG_START_PROCESS = 0x03;
 const uint8_t TAG_STATUS_REQUEST = 0x04;
 const uint8_t TAG_RESULT = 0x05;
 const uint8_t TAG_STATUS_RESP = 0x06;
+const uint8_t TAG_CANCEL = 0x07;
 
 const uint8_t STATUS_NOT_STARTED = 0x00;
 const uint8_t STATUS_IN_PROGRESS = 0x01;
 const uint8_t STATUS_FINISHED = 0x02;
+const uint8_t STATUS_CANCELLED = 0x03;
 
 #pragma pack(push, 1)
 struct TLVHeader {
@@ -133,6 +135,16 @@ bool deserializeMatrix(const vector<char>& buffer, int n, vector<vector<int>>& m
     return true;
 }
 
+// Сервер відповідає на CONFIG, START та CANCEL одним байтом статусу
+bool recvStatusResp(SOCKET sock, uint8_t& status) {
+    uint8_t respTag;
+    vector<char> respPayload;
+    if (!recvTLV(sock, respTag, respPayload) || respTag != TAG_STATUS_RESP || respPayload.empty())
+        return false;
+    status = respPayload[0];
+    return true;
+}
+
 void interactiveClient(SOCKET sock) {
     int n = 0, numThreads = 0;
     vector<vector<int>> matrix;
@@ -144,7 +156,8 @@ void interactiveClient(SOCKET sock) {
         cout << "2. Відправити матрицю\n";
         cout << "3. Запустити обчислення\n";
         cout << "4. Запитати статус/результат\n";
-        cout << "5. Завершити роботу\n";
+        cout << "5. Скасувати обчислення\n";
+        cout << "6. Завершити роботу\n";
         cout << "Виберіть опцію: ";
         int choice;
         cin >> choice;
@@ -159,10 +172,20 @@ void interactiveClient(SOCKET sock) {
             uint32_t threads_net = htonl(numThreads);
             memcpy(configPayload.data(), &n_net, sizeof(uint32_t));
             memcpy(configPayload.data() + 4, &threads_net, sizeof(uint32_t));
-            if (sendTLV(sock, TAG_CONFIG, configPayload))
-                cout << "Конфігурацію відправлено." << endl;
-            else
+            if (!sendTLV(sock, TAG_CONFIG, configPayload)) {
                 cerr << "Помилка надсилання конфігурації." << endl;
+                break;
+            }
+            uint8_t status;
+            if (!recvStatusResp(sock, status)) {
+                cerr << "Помилка отримання відповіді." << endl;
+                break;
+            }
+            if (status == STATUS_IN_PROGRESS) {
+                cerr << "Сервер відхилив конфігурацію: обчислення в процесі." << endl;
+                break;
+            }
+            cout << "Конфігурацію відправлено." << endl;
             configSent = true;
             matrixSent = false;
             break;
@@ -196,10 +219,19 @@ void interactiveClient(SOCKET sock) {
                 break;
             }
             vector<char> cmdPayload(1, 0x01);
-            if (sendTLV(sock, TAG_START_PROCESS, cmdPayload))
+            if (!sendTLV(sock, TAG_START_PROCESS, cmdPayload)) {
+                cerr << "Помилка надсилання команди." << endl;
+                break;
+            }
+            uint8_t status;
+            if (!recvStatusResp(sock, status)) {
+                cerr << "Помилка отримання відповіді." << endl;
+                break;
+            }
+            if (status == STATUS_IN_PROGRESS)
                 cout << "Команда запуску обчислень відправлена." << endl;
             else
-                cerr << "Помилка надсилання команди." << endl;
+                cerr << "Сервер відхилив запуск: недостатньо даних." << endl;
             break;
         }
         case 4: {
@@ -215,15 +247,25 @@ void interactiveClient(SOCKET sock) {
                 break;
             }
             if (respTag == TAG_STATUS_RESP) {
-                if (respPayload.size() != 1) {
+                if (respPayload.size() != 1 && respPayload.size() != 6) {
                     cerr << "Невірний формат відповіді статусу." << endl;
                     break;
                 }
                 uint8_t status = respPayload[0];
                 if (status == STATUS_NOT_STARTED)
                     cout << "Статус: Обчислення не запущено." << endl;
-                else if (status == STATUS_IN_PROGRESS)
-                    cout << "Статус: Обчислення в процесі." << endl;
+                else if (status == STATUS_IN_PROGRESS) {
+                    cout << "Статус: Обчислення в процесі.";
+                    if (respPayload.size() == 6) {
+                        uint32_t rateNet;
+                        memcpy(&rateNet, respPayload.data() + 2, sizeof(rateNet));
+                        cout << " Виконано " << (int)(uint8_t)respPayload[1] << "%, "
+                            << ntohl(rateNet) << " ел./с";
+                    }
+                    cout << endl;
+                }
+                else if (status == STATUS_CANCELLED)
+                    cout << "Статус: Обчислення скасовано." << endl;
                 else
                     cout << "Невідомий статус." << endl;
             }
@@ -246,6 +288,25 @@ void interactiveClient(SOCKET sock) {
             break;
         }
         case 5: {
+            vector<char> empty;
+            if (!sendTLV(sock, TAG_CANCEL, empty)) {
+                cerr << "Помилка надсилання команди скасування." << endl;
+                break;
+            }
+            uint8_t status;
+            if (!recvStatusResp(sock, status)) {
+                cerr << "Помилка отримання відповіді." << endl;
+                break;
+            }
+            if (status == STATUS_CANCELLED) {
+                cout << "Обчислення скасовано." << endl;
+                matrixSent = false;
+            }
+            else
+                cout << "Обчислення не запущено, скасовувати нічого." << endl;
+            break;
+        }
+        case 6: {
             exitFlag = true;
             cout << "Завершення роботи." << endl;
             break;
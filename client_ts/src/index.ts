@@ -11,10 +11,12 @@ const TAG_START_PROCESS = 0x03;
 const TAG_STATUS_REQUEST = 0x04;
 const TAG_RESULT = 0x05;
 const TAG_STATUS_RESP = 0x06;
+const TAG_CANCEL = 0x07;
 
 const STATUS_NOT_STARTED = 0x00;
 const STATUS_IN_PROGRESS = 0x01;
 const STATUS_FINISHED = 0x02;
+const STATUS_CANCELLED = 0x03;
 
 class TLVClient extends EventEmitter {
   private socket: net.Socket;
@@ -100,7 +102,8 @@ async function main() {
 2. Відправити матрицю
 3. Запустити обчислення
 4. Запитати статус/результат
-5. Завершити роботу
+5. Скасувати обчислення
+6. Завершити роботу
 `);
     const choice = await question("Виберіть опцію: ");
 
@@ -161,8 +164,16 @@ async function main() {
           const status = payload.readUInt8(0);
           if (status === STATUS_NOT_STARTED)
             console.log("Статус: Обчислення не запущено.");
-          else if (status === STATUS_IN_PROGRESS)
-            console.log("Статус: Обчислення в процесі.");
+          else if (status === STATUS_IN_PROGRESS) {
+            if (payload.length >= 6)
+              console.log(
+                `Статус: Обчислення в процесі. Виконано ${payload.readUInt8(
+                  1
+                )}%, ${payload.readUInt32BE(2)} ел./с`
+              );
+            else console.log("Статус: Обчислення в процесі.");
+          } else if (status === STATUS_CANCELLED)
+            console.log("Статус: Обчислення скасовано.");
           else console.log("Статус: Невідомий код", status);
         } else if (tag === TAG_RESULT) {
           const result: number[][] = [];
@@ -184,6 +195,15 @@ async function main() {
         break;
       }
       case "5": {
+        client.sendTLV(TAG_CANCEL, Buffer.alloc(0));
+        const { tag, payload } = await client.waitForMessage();
+        if (tag === TAG_STATUS_RESP && payload.readUInt8(0) === STATUS_CANCELLED) {
+          console.log("Обчислення скасовано.");
+          matrixSent = false;
+        } else console.log("Обчислення не запущено, скасовувати нічого.");
+        break;
+      }
+      case "6": {
         console.log("Завершення роботи.");
         rl.close();
         client.close();
@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <chrono>
 #include <mutex>
+#include <atomic>
 #include <cstring>
 #include <exception>
 
@@ -23,10 +24,15 @@ const uint8_t TAG_START_PROCESS = 0x03;
 const uint8_t TAG_STATUS_REQUEST = 0x04;
 const uint8_t TAG_RESULT = 0x05;
 const uint8_t TAG_STATUS_RESP = 0x06;
+const uint8_t TAG_CANCEL = 0x07;
 
 const uint8_t STATUS_NOT_STARTED = 0x00;
 const uint8_t STATUS_IN_PROGRESS = 0x01;
 const uint8_t STATUS_FINISHED = 0x02;
+const uint8_t STATUS_CANCELLED = 0x03;
+
+// Кількість рядків, після яких потік публікує прогрес і перевіряє скасування
+const int ROWS_PER_BAND = 16;
 
 #pragma pack(push, 1)
 struct TLVHeader {
@@ -112,7 +118,15 @@ bool validateMatrix(const vector<vector<int>>& m, int expected) {
     return true;
 }
 
-void parallelProcessMatrix(vector<vector<int>>& matrix, int numThreads) {
+struct ProcessProgress {
+    atomic<int> rowsDone{ 0 };
+    atomic<bool> cancelRequested{ false };
+    int totalRows = 0;
+    steady_clock::time_point startTime;
+};
+
+// Повертає false, якщо обчислення було скасовано через progress->cancelRequested
+bool parallelProcessMatrix(vector<vector<int>>& matrix, int numThreads, ProcessProgress* progress = nullptr) {
     int n = (int)matrix.size();
     vector<int> minValues(n);
     vector<thread> threads;
@@ -124,24 +138,35 @@ void parallelProcessMatrix(vector<vector<int>>& matrix, int numThreads) {
     for (int t = 0; t < numThreads; t++) {
         int count = rowsPerThread + (t < rem ? 1 : 0);
         int end = start + count;
-        threads.emplace_back([start, end, n, &matrix, &minValues]() {
-            for (int i = start; i < end; i++) {
-                int col = n - 1 - i;
-                int minVal = matrix[0][col];
-                for (int j = 1; j < n; j++)
-                    if (matrix[j][col] < minVal)
-                        minVal = matrix[j][col];
-                minValues[i] = minVal;
+        threads.emplace_back([start, end, n, &matrix, &minValues, progress]() {
+            for (int bandStart = start; bandStart < end; bandStart += ROWS_PER_BAND) {
+                if (progress && progress->cancelRequested.load(memory_order_relaxed))
+                    return;
+                int bandEnd = bandStart + ROWS_PER_BAND < end ? bandStart + ROWS_PER_BAND : end;
+                for (int i = bandStart; i < bandEnd; i++) {
+                    int col = n - 1 - i;
+                    int minVal = matrix[0][col];
+                    for (int j = 1; j < n; j++)
+                        if (matrix[j][col] < minVal)
+                            minVal = matrix[j][col];
+                    minValues[i] = minVal;
+                }
+                if (progress)
+                    progress->rowsDone.fetch_add(bandEnd - bandStart, memory_order_relaxed);
             }
             });
         start = end;
     }
     for (auto& t : threads) t.join();
 
+    if (progress && progress->cancelRequested.load())
+        return false;
+
     for (int i = 0; i < n; i++) {
         int col = n - 1 - i;
         matrix[i][col] = minValues[i];
     }
+    return true;
 }
 
 struct SessionState {
@@ -153,18 +178,46 @@ struct SessionState {
     bool matrixReceived = false;
     bool processingStarted = false;
     bool processingFinished = false;
+    bool processingCancelled = false;
     mutex mtx;
+    // Оновлюється потоками обчислень без захоплення mtx
+    ProcessProgress progress;
 };
 
+// Формує відповідь статусу: [status], а для STATUS_IN_PROGRESS ще
+// [percent:1][elementsPerSec:4, network order]
+vector<char> buildStatusPayload(uint8_t status, const ProcessProgress& progress) {
+    vector<char> payload(1, status);
+    if (status != STATUS_IN_PROGRESS) return payload;
+
+    int n = progress.totalRows;
+    int rows = progress.rowsDone.load(memory_order_relaxed);
+    uint8_t percent = n > 0 ? (uint8_t)((int64_t)rows * 100 / n) : 0;
+    double secs = duration<double>(steady_clock::now() - progress.startTime).count();
+    double rate = secs > 0 ? (double)rows * n / secs : 0.0;
+    uint32_t rateNet = htonl(rate > 4294967295.0 ? 0xFFFFFFFFu : (uint32_t)rate);
+
+    payload.push_back((char)percent);
+    payload.resize(payload.size() + sizeof(rateNet));
+    memcpy(payload.data() + 2, &rateNet, sizeof(rateNet));
+    return payload;
+}
+
 void processingTask(SessionState* state) {
     try {
         vector<vector<int>> localM;
         int threadsCnt, size;
         {
             lock_guard<mutex> lk(state->mtx);
+            if (state->progress.cancelRequested) {
+                state->processingFinished = true;
+                return;
+            }
             localM = state->matrix;
             threadsCnt = state->numThreads;
             size = state->n;
+            // Копіювання матриці не входить у час обчислень для elements/s
+            state->progress.startTime = steady_clock::now();
         }
 
         if (threadsCnt <= 0 || threadsCnt > size) {
@@ -182,13 +235,21 @@ void processingTask(SessionState* state) {
         }
 
         auto t0 = high_resolution_clock::now();
-        parallelProcessMatrix(localM, threadsCnt);
+        bool completed = parallelProcessMatrix(localM, threadsCnt, &state->progress);
         auto t1 = high_resolution_clock::now();
         auto dur = duration_cast<milliseconds>(t1 - t0).count();
+        if (!completed) {
+            cout << "Обробку скасовано через " << dur << " мс\n";
+            lock_guard<mutex> lk(state->mtx);
+            state->processingFinished = true;
+            return;
+        }
         cout << "Обробка завершена за " << dur << " мс\n";
 
         lock_guard<mutex> lk(state->mtx);
-        state->resultMatrix = move(localM);
+        // CANCEL міг надійти вже після завершення обчислень — результат нікому не потрібен
+        if (!state->processingCancelled)
+            state->resultMatrix = move(localM);
         state->processingFinished = true;
     }
     catch (const exception& e) {
@@ -204,9 +265,10 @@ void processingTask(SessionState* state) {
 }
 
 void clientHandler(SOCKET clientSock) {
+    SessionState state;
+    thread worker;
     try {
         cout << "Новий клієнт підключився.\n";
-        SessionState state;
         uint8_t tag;
         vector<char> payload;
 
@@ -217,11 +279,13 @@ void clientHandler(SOCKET clientSock) {
                     lock_guard<mutex> lk(state.mtx);
                     if (state.processingStarted && !state.processingFinished) {
                         cerr << "[Error] Невозможно изменить конфиг во время обработки\n";
+                        sendTLV(clientSock, TAG_STATUS_RESP, vector<char>(1, STATUS_IN_PROGRESS));
                         break;
                     }
                 }
                 if (payload.size() != 8) {
                     cerr << "[Error] Неверный размер CONFIG\n";
+                    sendTLV(clientSock, TAG_STATUS_RESP, vector<char>(1, STATUS_NOT_STARTED));
                     break;
                 }
                 uint32_t n_net, th_net;
@@ -237,6 +301,7 @@ void clientHandler(SOCKET clientSock) {
                     state.matrixReceived = false;
                     state.processingStarted = false;
                     state.processingFinished = false;
+                    state.processingCancelled = false;
                 }
                 cout << "Отримано CONFIG: n=" << n << ", threads=" << threads << "\n";
                 sendTLV(clientSock, TAG_STATUS_RESP, vector<char>(1, STATUS_NOT_STARTED));
@@ -271,34 +336,46 @@ void clientHandler(SOCKET clientSock) {
                     lock_guard<mutex> lk(state.mtx);
                     if (!state.configReceived || !state.matrixReceived) {
                         cerr << "[Error] Недостатньо даних для початку обчислень\n";
+                        sendTLV(clientSock, TAG_STATUS_RESP, vector<char>(1, STATUS_NOT_STARTED));
                         break;
                     }
                     if (state.processingStarted && !state.processingFinished) {
                         cerr << "[Error] Обчислення вже запущено\n";
+                        sendTLV(clientSock, TAG_STATUS_RESP, vector<char>(1, STATUS_IN_PROGRESS));
                         break;
                     }
                     state.processingStarted = true;
                     state.processingFinished = false;
+                    state.processingCancelled = false;
+                    state.progress.rowsDone = 0;
+                    state.progress.cancelRequested = false;
+                    state.progress.totalRows = state.n;
                 }
                 cout << "Запуск обчислень...\n";
-                thread(processingTask, &state).detach();
+                if (worker.joinable()) worker.join();
+                worker = thread(processingTask, &state);
                 sendTLV(clientSock, TAG_STATUS_RESP, vector<char>(1, STATUS_IN_PROGRESS));
                 break;
             }
 
             case TAG_STATUS_REQUEST: {
                 uint8_t status;
+                vector<char> statusPayload;
                 {
                     lock_guard<mutex> lk(state.mtx);
                     if (!state.processingStarted)
                         status = STATUS_NOT_STARTED;
+                    else if (state.processingCancelled)
+                        status = STATUS_CANCELLED;
                     else if (!state.processingFinished)
                         status = STATUS_IN_PROGRESS;
                     else
                         status = STATUS_FINISHED;
+                    if (status != STATUS_FINISHED)
+                        statusPayload = buildStatusPayload(status, state.progress);
                 }
                 if (status != STATUS_FINISHED) {
-                    sendTLV(clientSock, TAG_STATUS_RESP, vector<char>(1, status));
+                    sendTLV(clientSock, TAG_STATUS_RESP, statusPayload);
                 }
                 else {
                     vector<char> resultBuf;
@@ -308,6 +385,28 @@ void clientHandler(SOCKET clientSock) {
                 break;
             }
 
+            case TAG_CANCEL: {
+                uint8_t status;
+                {
+                    lock_guard<mutex> lk(state.mtx);
+                    if (state.processingStarted && !state.processingCancelled) {
+                        if (!state.processingFinished)
+                            state.progress.cancelRequested = true;
+                        state.processingCancelled = true;
+                        vector<vector<int>>().swap(state.matrix);
+                        vector<vector<int>>().swap(state.resultMatrix);
+                        state.matrixReceived = false;
+                    }
+                    status = state.processingCancelled ? STATUS_CANCELLED : STATUS_NOT_STARTED;
+                }
+                // Відповідаємо лише після зупинки потоків: локальна копія вже звільнена,
+                // і наступні CONFIG/MATRIX/START не будуть відхилені
+                if (worker.joinable()) worker.join();
+                cout << "Отримано CANCEL\n";
+                sendTLV(clientSock, TAG_STATUS_RESP, vector<char>(1, status));
+                break;
+            }
+
             default:
                 cerr << "[Warning] Невідомий тег: " << (int)tag << "\n";
                 break;
@@ -321,6 +420,9 @@ void clientHandler(SOCKET clientSock) {
     catch (...) {
         cerr << "[Unknown exception] в clientHandler\n";
     }
+    // Клієнт більше не чекає результату — зупиняємо обчислення до знищення state
+    state.progress.cancelRequested = true;
+    if (worker.joinable()) worker.join();
     closesocket(clientSock);
 }
 